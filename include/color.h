@@ -9,23 +9,99 @@
 
 #define MAX_STR_LEN 64
 
-struct color {
-  uint8_t r;
-  uint8_t g;
-  uint8_t b;
-};
-
-int parse_rgb(const char *value, struct color *color);
-int parse_hex(const char *value, struct color *color);
-int parse_hsl(const char *value, struct color *color);
-int parse_percent(const char *value, struct color *color);
-int parse_ratio(const char *value, struct color *color);
-
-void format_rgb(const struct color color, char *buffer);
-void format_hex(const struct color color, char *buffer);
-void format_hsl(const struct color color, char *buffer);
-void format_percent(const struct color color, char *buffer);
-void format_ratio(const struct color color, char *buffer);
+/*
+ * Size in bytes of a single color in each raw format
+ */
+#define RGB24_SIZE 3
+#define RGBA32_SIZE 4
+#define PLANAR_SIZE 3
+#define HEX_SIZE 6
+
+/*
+ * Every supported bit depth, the color struct, parse and format kernels of a
+ * depth are all generated from its row in this table
+ *
+ * # Columns
+ * - name: Name of the color struct
+ * - sfx: Suffix appended to the parse_* and format_* functions
+ * - type: Type of a single channel
+ * - integral: 1 if the channel is an integer, 0 if it is a floating point
+ * - rounded: 1 if parsed values are rounded to the nearest channel, 0 if they
+ *   are truncated
+ * - max: Channel value of full intensity
+ * - rgb_max: Value of full intensity in the RGB string
+ * - rgb_prec: Decimals of the RGB string, 0 for integer only values
+ * - hex_width: Hex digits per channel in the HEX string
+ * - hsl_prec: Decimals of the HSL string
+ * - percent_prec: Decimals of the percentage string
+ * - ratio_prec: Decimals of the ratio string
+ */
+#define COLOR_DEPTHS(X) \
+  X(color,   ,   uint8_t,  1, 0, 255.0,   255.0,   0, 2, 0, 0, 2) \
+  X(color16, 16, uint16_t, 1, 1, 65535.0, 65535.0, 0, 4, 4, 3, 5) \
+  X(colorf,  f,  float,    0, 0, 1.0,     255.0,   3, 4, 4, 4, 6)
+
+/*
+ * Every pair of bit depths that can be converted into one another
+ */
+#define COLOR_CONVERSIONS(X) \
+  X(color,   color16) \
+  X(color,   colorf) \
+  X(color16, color) \
+  X(color16, colorf) \
+  X(colorf,  color) \
+  X(colorf,  color16)
+
+/*
+ * Every string format, each has a parse and a format kernel at every depth
+ */
+#define COLOR_FORMATS(X, name, sfx) \
+  X(name, sfx, rgb) \
+  X(name, sfx, hex) \
+  X(name, sfx, hsl) \
+  X(name, sfx, percent) \
+  X(name, sfx, ratio)
+
+#define COLOR_DECLARE_BATCH(name, sfx, fmt) \
+  int parse_##fmt##sfx##_batch(const char *const *restrict values, struct name *restrict colors, size_t n); \
+  void format_##fmt##sfx##_batch(const struct name *restrict colors, char (*restrict buffers)[MAX_STR_LEN], size_t n);
+
+#define COLOR_DECLARE(name, sfx, type, ...) \
+  struct name { \
+    type r; \
+    type g; \
+    type b; \
+  }; \
+  \
+  int parse_rgb##sfx(const char *value, struct name *color); \
+  int parse_hex##sfx(const char *value, struct name *color); \
+  int parse_hsl##sfx(const char *value, struct name *color); \
+  int parse_percent##sfx(const char *value, struct name *color); \
+  int parse_ratio##sfx(const char *value, struct name *color); \
+  \
+  void format_rgb##sfx(const struct name color, char *buffer); \
+  void format_hex##sfx(const struct name color, char *buffer); \
+  void format_hsl##sfx(const struct name color, char *buffer); \
+  void format_percent##sfx(const struct name color, char *buffer); \
+  void format_ratio##sfx(const struct name color, char *buffer); \
+  \
+  COLOR_FORMATS(COLOR_DECLARE_BATCH, name, sfx)
+
+#define COLOR_DECLARE_CONVERSION(from, to) \
+  void convert_##from##_to_##to(const struct from *restrict src, struct to *restrict dst, size_t n);
+
+COLOR_DEPTHS(COLOR_DECLARE)
+COLOR_CONVERSIONS(COLOR_DECLARE_CONVERSION)
+
+void pack_rgb24(const struct color *restrict src, uint8_t *restrict dst, size_t n);
+void pack_rgba32(const struct color *restrict src, uint8_t *restrict dst, size_t n);
+void pack_planar(const struct color *restrict src, uint8_t *restrict dst, size_t n);
+void pack_hex(const struct color *restrict src, char *restrict dst, size_t n);
+
+void unpack_rgb24(const uint8_t *restrict src, struct color *restrict dst, size_t n);
+void unpack_rgba32(const uint8_t *restrict src, struct color *restrict dst, size_t n);
+void unpack_planar(const uint8_t *restrict src, struct color *restrict dst, size_t n);
+int unpack_hex(const char *restrict src, struct color *restrict dst, size_t n);
 
 double hue_to_rgb_comp(double p, double q, double t);
 
@@ -41,259 +41,581 @@ int rgb_to_str(int r, int g, int b, char *buffer) {
 }
 
 /**
- * Parse a RGB color string into a RGB color struct
+ * Check that three values lie in the range [0, max]
  *
  * # Parameters
- * - value: RGB color string
- * - color: Address of the color struct
+ * - a, b, c: Values to check
+ * - max: Upper bound of the range
  *
  * # Return
- * 0 on success, 1 on failure
+ * 1 if all three are in range, 0 otherwise
  */
-int parse_rgb(const char *value, struct color *color) {
-  if (value == NULL || color == NULL) { return 1; }
-
-  int r, g, b;
-  if (sscanf(value, "%d , %d , %d", &r, &g, &b) != 3) { return 1; }
-
-  if (r < 0 || r > 255) { return 1; }
-  if (g < 0 || g > 255) { return 1; }
-  if (b < 0 || b > 255) { return 1; }
-
-  *color = (struct color) { (int8_t) r, (int8_t) g, (int8_t) b };
-
-  return 0;
+static int in_range(double a, double b, double c, double max) {
+  return a >= 0.0 && a <= max && b >= 0.0 && b <= max && c >= 0.0 && c <= max;
 }
 
 /**
- * Parse a HEX color string into a RGB color struct
+ * Parse a comma-separated string of three numbers
  *
  * # Parameters
- * - value: HEX color string
- * - color: Address of the color struct
+ * - value: Comma-separated string
+ * - a, b, c: Address of the parsed numbers
  *
  * # Return
  * 0 on success, 1 on failure
  */
-int parse_hex(const char *value, struct color *color) {
-  if (value == NULL || color == NULL) { return 1; }
-
-  const char *value_start = value[0] == '#' ? value + 1 : value;
-
-  unsigned int r, g, b;
-  size_t len = strlen(value_start);
-
-  if (len != 6 || len >= MAX_STR_LEN) { return 1; }
-
-  if (sscanf(value_start, "%2x%2x%2x", &r, &g, &b) != 3) { return 1; }
-
-  if (r > 255) { return 1; }
-  if (g > 255) { return 1; }
-  if (b > 255) { return 1; }
-
-  *color = (struct color) { (int8_t) r, (int8_t) g, (int8_t) b };
+static int parse_triple(const char *value, double *a, double *b, double *c) {
+  if (sscanf(value, "%lf , %lf , %lf", a, b, c) != 3) { return 1; }
 
   return 0;
 }
 
 /**
- * Parse a HSL color string into a RGB color struct
+ * Parse a comma-separated string of three integers
  *
  * # Parameters
- * - value: HSL color string
- * - color: Address of the color struct
+ * - value: Comma-separated string
+ * - a, b, c: Address of the parsed integers
  *
  * # Return
  * 0 on success, 1 on failure
  */
-int parse_hsl(const char *value, struct color *color) {
-  if (value == NULL || color == NULL) { return 1; }
+static int parse_int_triple(const char *value, double *a, double *b, double *c) {
+  int ia, ib, ic;
+  if (sscanf(value, "%d , %d , %d", &ia, &ib, &ic) != 3) { return 1; }
 
-  double h, s, l;
-  if (sscanf(value, "%lf , %lf , %lf", &h, &s, &l) != 3) { return 1; }
-  
-  if (h < 0.0 || h > 360.0) { return 1; }
-  if (s < 0.0 || s > 100.0) { return 1; }
-  if (l < 0.0 || l > 100.0) { return 1; }
+  *a = ia;
+  *b = ib;
+  *c = ic;
 
-  h /= 360.0;
-  s /= 100.0;
-  l /= 100.0;
+  return 0;
+}
 
-  double r, g, b;
-  if (s == 0) {
-    r = g = b = l;
+/**
+ * Format three numbers into a comma-separated string, numbers are truncated
+ * when printed without decimals and rounded otherwise
+ *
+ * # Parameters
+ * - buffer: Output buffer to store the generated string
+ * - prec: Number of decimals to print
+ * - a, b, c: Numbers to format
+ */
+static void format_triple(char *buffer, int prec, double a, double b, double c) {
+  if (prec == 0) {
+    (void)snprintf(buffer, MAX_STR_LEN, "%d,%d,%d", (int) a, (int) b, (int) c);
   } else {
-    double q = l < 0.5 ? l * (1.0 + s) : l + s - l * s;
-    double p = 2.0 * l - q;
-    r = hue_to_rgb_comp(p, q, h + 1.0 / 3.0);
-    g = hue_to_rgb_comp(p, q, h);
-    b = hue_to_rgb_comp(p, q, h - 1.0 / 3.0);
+    (void)snprintf(buffer, MAX_STR_LEN, "%.*f,%.*f,%.*f", prec, a, prec, b, prec, c);
   }
-
-  r *= 255.0;
-  g *= 255.0;
-  b *= 255.0;
-
-  *color = (struct color) { (int8_t) r, (int8_t) g, (int8_t) b };
-
-  return 0;
 }
 
 /**
- * Parse a Percentage color string into a RGB color struct
+ * Convert a hex digit to its value
  *
  * # Parameters
- * - value: Percentage color string
- * - color: Address of the color struct
+ * - c: Hex digit, lower or upper case
  *
  * # Return
- * 0 on success, 1 on failure
+ * Value of the digit, -1 if c is not a hex digit
  */
-int parse_percent(const char *value, struct color *color) {
-  if (value == NULL || color == NULL) { return 1; }
-
-  float pr, pg, pb;
-  if (sscanf(value, "%f , %f , %f", &pr, &pg, &pb) != 3) { return 1; }
-
-  if (pr < 0.0 || pr > 100.0) { return 1; }
-  if (pg < 0.0 || pg > 100.0) { return 1; }
-  if (pb < 0.0 || pb > 100.0) { return 1; }
-  
-  float r = 255.0 * pr / 100.0;
-  float g = 255.0 * pg / 100.0;
-  float b = 255.0 * pb / 100.0;
-
-  *color = (struct color) { (int8_t) r, (int8_t) g, (int8_t) b };
-
-  return 0;
+static int hex_digit(char c) {
+  if (c >= '0' && c <= '9') { return c - '0'; }
+  if (c >= 'a' && c <= 'f') { return c - 'a' + 10; }
+  if (c >= 'A' && c <= 'F') { return c - 'A' + 10; }
+  return -1;
 }
 
 /**
- * Parse a Ratio color string into a RGB color struct
+ * Parse a HEX color string with a fixed number of digits per channel
  *
  * # Parameters
- * - value: Ratio color string
- * - color: Address of the color struct
+ * - value: HEX color string, with or without a leading '#'
+ * - width: Number of hex digits per channel
+ * - r, g, b: Address of the parsed channels
  *
  * # Return
  * 0 on success, 1 on failure
  */
-int parse_ratio(const char *value, struct color *color) {
-  if (value == NULL || color == NULL) { return 1; }
+static int parse_hex_triple(const char *value, int width, unsigned int *r, unsigned int *g, unsigned int *b) {
+  const char *value_start = value[0] == '#' ? value + 1 : value;
 
-  float rr, rg, rb;
-  if (sscanf(value, "%f , %f , %f", &rr, &rg, &rb) != 3) { return 1; }
+  size_t len = strlen(value_start);
+  if (len != (size_t) (3 * width) || len >= MAX_STR_LEN) { return 1; }
 
-  if (rr < 0.0 || rr > 1.0) { return 1; }
-  if (rg < 0.0 || rg > 1.0) { return 1; }
-  if (rb < 0.0 || rb > 1.0) { return 1; }
-  
-  float r = 255.0 * rr;
-  float g = 255.0 * rg;
-  float b = 255.0 * rb;
+  unsigned int channels[3] = { 0, 0, 0 };
+  for (size_t i = 0; i < len; i++) {
+    int digit = hex_digit(value_start[i]);
+    if (digit < 0) { return 1; }
+    channels[i / width] = channels[i / width] << 4 | (unsigned int) digit;
+  }
 
-  *color = (struct color) { (int8_t) r, (int8_t) g, (int8_t) b };
+  *r = channels[0];
+  *g = channels[1];
+  *b = channels[2];
 
   return 0;
 }
 
 /**
- * Format a RGB color struct into a RGB color string
+ * Clamp a channel to the range of a HEX color string
  *
- * # Parameter:
- * - color: RGB color struct
- * - buffer: Address to a string buffer to write RGB color string
+ * # Parameters
+ * - value: Channel in the scale of the HEX string
+ * - max: Largest value of a channel in the HEX string
+ *
+ * # Return
+ * Channel clamped to [0, max], 0 for NaN
  */
-void format_rgb(const struct color color, char *buffer) {
-  if (buffer == NULL) { return; }
-
-  (void)snprintf(buffer, 12, "%d,%d,%d", color.r, color.g, color.b);
+static unsigned int hex_clamp(double value, double max) {
+  return (unsigned int) fmin(fmax(value, 0.0), max);
 }
 
 /**
- * Format a RGB color struct into a HEX color string
+ * Convert a HSL color to its RGB components
  *
- * # Parameter:
- * - color: RGB color struct
- * - buffer: Address to a string buffer to write HEX color string
+ * # Parameters
+ * - h, s, l: Hue, saturation and lightness, all in [0, 1]
+ * - r, g, b: Address of the RGB components, all in [0, 1]
  */
-void format_hex(const struct color color, char *buffer) {
-  if (buffer == NULL) { return; }
-
-  (void)snprintf(buffer, 8, "#%02x%02x%02x", color.r, color.g, color.b);
+static void hsl_to_rgb(double h, double s, double l, double *r, double *g, double *b) {
+  if (s == 0) {
+    *r = *g = *b = l;
+  } else {
+    double q = l < 0.5 ? l * (1.0 + s) : l + s - l * s;
+    double p = 2.0 * l - q;
+    *r = hue_to_rgb_comp(p, q, h + 1.0 / 3.0);
+    *g = hue_to_rgb_comp(p, q, h);
+    *b = hue_to_rgb_comp(p, q, h - 1.0 / 3.0);
+  }
 }
 
 /**
- * Format a RGB color struct into a HSL color string
+ * Convert RGB components to a HSL color
  *
- * # Parameter:
- * - color: RGB color struct
- * - buffer: Address to a string buffer to write HSL color string
+ * # Parameters
+ * - r, g, b: RGB components, all in [0, 1]
+ * - h: Address of the hue, in sixths of a turn
+ * - s, l: Address of the saturation and lightness, in [0, 1]
  */
-void format_hsl(const struct color color, char *buffer) {
-  if (buffer == NULL) { return; }
-
-  double tr = (double) color.r / 255.0;
-  double tg = (double) color.g / 255.0;
-  double tb = (double) color.b / 255.0;
-
-  double h = 0, s = 0, l = 0;
-  double max = fmax(tr, fmax(tg, tb));
-  double min = fmin(tr, fmin(tg, tb));
+static void rgb_to_hsl(double r, double g, double b, double *h, double *s, double *l) {
+  double max = fmax(r, fmax(g, b));
+  double min = fmin(r, fmin(g, b));
   double delta = (max - min);
 
   if (delta == 0) {
-    h = 0;
-  } else if (max == tr) {
-    h = fmod(((tg - tb) / delta), 6);
-  } else if (max == tg) {
-    h = ((tb - tr) / delta) + 2.0;
-  } else if (max == tb) {
-    h = ((tr - tg) / delta) + 4.0;
+    *h = 0;
+  } else if (max == r) {
+    *h = fmod(((g - b) / delta), 6);
+    if (*h < 0) { *h += 6; } /* fmod keeps the sign, hues are in [0, 6) */
+  } else if (max == g) {
+    *h = ((b - r) / delta) + 2.0;
+  } else {
+    *h = ((r - g) / delta) + 4.0;
   }
 
-  l = (max + min) / 2.0;
+  *l = (max + min) / 2.0;
 
-  if (l == 0.0 || l == 1.0) {
-    s = 0;
+  if (*l == 0.0 || *l == 1.0) {
+    *s = 0;
   } else {
-    s = delta / (1 - fabs(2 * l - 1));
+    *s = delta / (1 - fabs(2 * *l - 1));
   }
+}
 
-  (void)snprintf(buffer, 12, "%d,%d,%d", (int) (h * 60), (int) (s * 100), (int) (l * 100));
+/*
+ * Define the kernels of a bit depth from its row of COLOR_DEPTHS
+ *
+ * Every string format is read and written in its own scale (255 for RGB, 100
+ * for percentage, 1 for ratio...), name##_channel and name##_scaled move a
+ * value between that scale and the channel. Values are scaled as
+ * `max * value / scale` so that integer values in the native scale of a
+ * channel convert exactly, parsed values are then rounded or truncated
+ * according to the rounded column
+ *
+ * # Generated functions
+ * - parse_rgb##sfx: Parse a RGB color string, values in [0, rgb_max], integers
+ *   only when rgb_prec is 0
+ * - parse_hex##sfx: Parse a HEX color string of hex_width digits per channel
+ * - parse_hsl##sfx: Parse a HSL color string
+ * - parse_percent##sfx: Parse a percentage color string
+ * - parse_ratio##sfx: Parse a ratio color string
+ * - format_rgb##sfx: Format into a RGB color string with rgb_prec decimals
+ * - format_hex##sfx: Format into a HEX color string of hex_width digits per channel
+ * - format_hsl##sfx: Format into a HSL color string with hsl_prec decimals
+ * - format_percent##sfx: Format into a percentage color string with percent_prec decimals
+ * - format_ratio##sfx: Format into a ratio color string with ratio_prec decimals
+ *
+ * All parse functions return 0 on success, 1 on failure
+ */
+#define COLOR_DEFINE(name, sfx, type, integral, rounded, max, rgb_max, rgb_prec, hex_width, hsl_prec, percent_prec, ratio_prec) \
+  typedef type name##_type; \
+  _Static_assert(sizeof(struct name) == 3 * sizeof(type), "struct " #name " must hold three packed channels"); \
+  \
+  static const int name##_integral = integral; \
+  static const double name##_max = max; \
+  static const double name##_parse_round = rounded ? 0.5 : 0.0; \
+  static const double name##_convert_round = integral ? 0.5 : 0.0; \
+  \
+  static inline type name##_cast(double value) { \
+    if (integral) { \
+      value = value > 0.0 ? value : 0.0; \
+      value = value < max ? value : max; \
+    } \
+    return (type) value; \
+  } \
+  \
+  static inline type name##_channel(double value, double scale, double round) { \
+    return name##_cast(max * value / scale + round); \
+  } \
+  \
+  static inline double name##_scaled(type channel, double scale) { \
+    return scale * (double) channel / max; \
+  } \
+  \
+  int parse_rgb##sfx(const char *value, struct name *color) { \
+    if (value == NULL || color == NULL) { return 1; } \
+    \
+    double r, g, b; \
+    if (rgb_prec == 0) { \
+      if (parse_int_triple(value, &r, &g, &b) != 0) { return 1; } \
+    } else if (parse_triple(value, &r, &g, &b) != 0) { \
+      return 1; \
+    } \
+    \
+    if (!in_range(r, g, b, rgb_max)) { return 1; } \
+    \
+    *color = (struct name) { \
+      name##_channel(r, rgb_max, name##_parse_round), \
+      name##_channel(g, rgb_max, name##_parse_round), \
+      name##_channel(b, rgb_max, name##_parse_round), \
+    }; \
+    \
+    return 0; \
+  } \
+  \
+  int parse_hex##sfx(const char *value, struct name *color) { \
+    if (value == NULL || color == NULL) { return 1; } \
+    \
+    const double hex_max = (double) ((1u << (4 * hex_width)) - 1); \
+    unsigned int r, g, b; \
+    if (parse_hex_triple(value, hex_width, &r, &g, &b) != 0) { return 1; } \
+    \
+    *color = (struct name) { \
+      name##_channel(r, hex_max, name##_parse_round), \
+      name##_channel(g, hex_max, name##_parse_round), \
+      name##_channel(b, hex_max, name##_parse_round), \
+    }; \
+    \
+    return 0; \
+  } \
+  \
+  int parse_hsl##sfx(const char *value, struct name *color) { \
+    if (value == NULL || color == NULL) { return 1; } \
+    \
+    double h, s, l; \
+    if (parse_triple(value, &h, &s, &l) != 0) { return 1; } \
+    \
+    if (h < 0.0 || h > 360.0) { return 1; } \
+    if (s < 0.0 || s > 100.0) { return 1; } \
+    if (l < 0.0 || l > 100.0) { return 1; } \
+    \
+    double r, g, b; \
+    hsl_to_rgb(h / 360.0, s / 100.0, l / 100.0, &r, &g, &b); \
+    \
+    *color = (struct name) { \
+      name##_channel(r, 1.0, name##_parse_round), \
+      name##_channel(g, 1.0, name##_parse_round), \
+      name##_channel(b, 1.0, name##_parse_round), \
+    }; \
+    \
+    return 0; \
+  } \
+  \
+  int parse_percent##sfx(const char *value, struct name *color) { \
+    if (value == NULL || color == NULL) { return 1; } \
+    \
+    double pr, pg, pb; \
+    if (parse_triple(value, &pr, &pg, &pb) != 0) { return 1; } \
+    \
+    if (!in_range(pr, pg, pb, 100.0)) { return 1; } \
+    \
+    *color = (struct name) { \
+      name##_channel(pr, 100.0, name##_parse_round), \
+      name##_channel(pg, 100.0, name##_parse_round), \
+      name##_channel(pb, 100.0, name##_parse_round), \
+    }; \
+    \
+    return 0; \
+  } \
+  \
+  int parse_ratio##sfx(const char *value, struct name *color) { \
+    if (value == NULL || color == NULL) { return 1; } \
+    \
+    double rr, rg, rb; \
+    if (parse_triple(value, &rr, &rg, &rb) != 0) { return 1; } \
+    \
+    if (!in_range(rr, rg, rb, 1.0)) { return 1; } \
+    \
+    *color = (struct name) { \
+      name##_channel(rr, 1.0, name##_parse_round), \
+      name##_channel(rg, 1.0, name##_parse_round), \
+      name##_channel(rb, 1.0, name##_parse_round), \
+    }; \
+    \
+    return 0; \
+  } \
+  \
+  void format_rgb##sfx(const struct name color, char *buffer) { \
+    if (buffer == NULL) { return; } \
+    \
+    format_triple(buffer, rgb_prec, \
+                  name##_scaled(color.r, rgb_max), \
+                  name##_scaled(color.g, rgb_max), \
+                  name##_scaled(color.b, rgb_max)); \
+  } \
+  \
+  void format_hex##sfx(const struct name color, char *buffer) { \
+    if (buffer == NULL) { return; } \
+    \
+    const double hex_max = (double) ((1u << (4 * hex_width)) - 1); \
+    (void)snprintf(buffer, MAX_STR_LEN, "#%0*x%0*x%0*x", \
+                   hex_width, hex_clamp(name##_scaled(color.r, hex_max), hex_max), \
+                   hex_width, hex_clamp(name##_scaled(color.g, hex_max), hex_max), \
+                   hex_width, hex_clamp(name##_scaled(color.b, hex_max), hex_max)); \
+  } \
+  \
+  void format_hsl##sfx(const struct name color, char *buffer) { \
+    if (buffer == NULL) { return; } \
+    \
+    double h, s, l; \
+    rgb_to_hsl(name##_scaled(color.r, 1.0), \
+               name##_scaled(color.g, 1.0), \
+               name##_scaled(color.b, 1.0), \
+               &h, &s, &l); \
+    \
+    format_triple(buffer, hsl_prec, h * 60, s * 100, l * 100); \
+  } \
+  \
+  void format_percent##sfx(const struct name color, char *buffer) { \
+    if (buffer == NULL) { return; } \
+    \
+    format_triple(buffer, percent_prec, \
+                  name##_scaled(color.r, 100.0), \
+                  name##_scaled(color.g, 100.0), \
+                  name##_scaled(color.b, 100.0)); \
+  } \
+  \
+  void format_ratio##sfx(const struct name color, char *buffer) { \
+    if (buffer == NULL) { return; } \
+    \
+    format_triple(buffer, ratio_prec, \
+                  name##_scaled(color.r, 1.0), \
+                  name##_scaled(color.g, 1.0), \
+                  name##_scaled(color.b, 1.0)); \
+  }
+
+/*
+ * Define the batch kernels of a string format at a bit depth
+ *
+ * # Generated functions
+ * - parse_##fmt##sfx##_batch: Parse n strings of values into colors, returns 0
+ *   on success, 1 as soon as a string fails to parse
+ * - format_##fmt##sfx##_batch: Format n colors into n buffers
+ */
+#define COLOR_DEFINE_BATCH(name, sfx, fmt) \
+  int parse_##fmt##sfx##_batch(const char *const *restrict values, struct name *restrict colors, size_t n) { \
+    for (size_t i = 0; i < n; i++) { \
+      if (parse_##fmt##sfx(values[i], &colors[i]) != 0) { return 1; } \
+    } \
+    \
+    return 0; \
+  } \
+  \
+  void format_##fmt##sfx##_batch(const struct name *restrict colors, char (*restrict buffers)[MAX_STR_LEN], size_t n) { \
+    for (size_t i = 0; i < n; i++) { format_##fmt##sfx(colors[i], buffers[i]); } \
+  }
+
+#define COLOR_DEFINE_BATCHES(name, sfx, ...) COLOR_FORMATS(COLOR_DEFINE_BATCH, name, sfx)
+
+/*
+ * Number of channels converted at once by a batch conversion, a constant
+ * count lets the compiler vectorize the inner loop at -O2
+ */
+#define CONVERT_BLOCK 48
+
+/*
+ * Define the batch conversion between two bit depths of COLOR_CONVERSIONS
+ *
+ * convert_##from##_to_##to converts n colors of src into dst, both buffers
+ * are owned by the caller and must not overlap. Colors are walked as a flat
+ * array of 3 * n channels in blocks of CONVERT_BLOCK, and every channel goes
+ * through from##_to_##to##_channel whose scale factor is a constant, so that
+ * the block loop is vectorized. Integer depths are converted with integer
+ * arithmetic, `(value * to_max + from_max / 2) / from_max` rounds to the
+ * nearest value as the maxima are odd. Other channels are scaled by the ratio
+ * of the maxima, which is an exact integer for every pair of depths, so exact
+ * values stay exact, and rounded to the nearest value when the destination is
+ * an integer
+ */
+#define COLOR_DEFINE_CONVERSION(from, to) \
+  static inline to##_type from##_to_##to##_channel(from##_type value) { \
+    if (from##_integral && to##_integral) { \
+      const uint32_t from_max = (uint32_t) from##_max; \
+      const uint32_t to_max = (uint32_t) to##_max; \
+      return (to##_type) ((value * to_max + from_max / 2) / from_max); \
+    } \
+    if (from##_max < to##_max) { \
+      return to##_cast((double) value * (to##_max / from##_max) + to##_convert_round); \
+    } \
+    return to##_cast((double) value / (from##_max / to##_max) + to##_convert_round); \
+  } \
+  \
+  void convert_##from##_to_##to(const struct from *restrict src, struct to *restrict dst, size_t n) { \
+    const from##_type *restrict in = (const from##_type *) src; \
+    to##_type *restrict out = (to##_type *) dst; \
+    size_t i = 0; \
+    \
+    for (; i + CONVERT_BLOCK <= 3 * n; i += CONVERT_BLOCK) { \
+      for (size_t j = i; j < i + CONVERT_BLOCK; j++) { out[j] = from##_to_##to##_channel(in[j]); } \
+    } \
+    for (; i < 3 * n; i++) { out[i] = from##_to_##to##_channel(in[i]); } \
+  }
+
+COLOR_DEPTHS(COLOR_DEFINE)
+COLOR_DEPTHS(COLOR_DEFINE_BATCHES)
+COLOR_CONVERSIONS(COLOR_DEFINE_CONVERSION)
+
+_Static_assert(sizeof(struct color) == RGB24_SIZE, "struct color must be packed RGB24");
+
+/**
+ * Pack colors into raw RGB24 bytes, three bytes per color
+ *
+ * # Parameters
+ * - src: Colors to pack
+ * - dst: Output buffer of at least n * RGB24_SIZE bytes
+ * - n: Number of colors
+ */
+void pack_rgb24(const struct color *restrict src, uint8_t *restrict dst, size_t n) {
+  memcpy(dst, src, n * RGB24_SIZE);
 }
 
 /**
- * Format a RGB color struct into a percentage color string
+ * Unpack raw RGB24 bytes into colors
  *
- * # Parameter:
- * - color: RGB color struct
- * - buffer: Address to a string buffer to write percentage color string
+ * # Parameters
+ * - src: Input buffer of n * RGB24_SIZE bytes
+ * - dst: Output colors
+ * - n: Number of colors
  */
-void format_percent(const struct color color, char *buffer) {
-  if (buffer == NULL) { return; }
+void unpack_rgb24(const uint8_t *restrict src, struct color *restrict dst, size_t n) {
+  memcpy(dst, src, n * RGB24_SIZE);
+}
 
-  float pr = 100.0 * (double) color.r / 255.0;
-  float pg = 100.0 * (double) color.g / 255.0;
-  float pb = 100.0 * (double) color.b / 255.0;
+/**
+ * Pack colors into raw RGBA32 bytes, four bytes per color with an opaque alpha
+ *
+ * # Parameters
+ * - src: Colors to pack
+ * - dst: Output buffer of at least n * RGBA32_SIZE bytes
+ * - n: Number of colors
+ */
+void pack_rgba32(const struct color *restrict src, uint8_t *restrict dst, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    dst[4 * i + 0] = src[i].r;
+    dst[4 * i + 1] = src[i].g;
+    dst[4 * i + 2] = src[i].b;
+    dst[4 * i + 3] = 255;
+  }
+}
 
-  (void)snprintf(buffer, 12, "%d,%d,%d", (int) pr, (int) pg, (int) pb);
+/**
+ * Unpack raw RGBA32 bytes into colors, the alpha channel is dropped
+ *
+ * # Parameters
+ * - src: Input buffer of n * RGBA32_SIZE bytes
+ * - dst: Output colors
+ * - n: Number of colors
+ */
+void unpack_rgba32(const uint8_t *restrict src, struct color *restrict dst, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    dst[i] = (struct color) { src[4 * i + 0], src[4 * i + 1], src[4 * i + 2] };
+  }
+}
+
+/**
+ * Pack colors into planar bytes: n red bytes, then n green bytes, then n blue
+ * bytes
+ *
+ * # Parameters
+ * - src: Colors to pack
+ * - dst: Output buffer of at least n * PLANAR_SIZE bytes
+ * - n: Number of colors
+ */
+void pack_planar(const struct color *restrict src, uint8_t *restrict dst, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    dst[i] = src[i].r;
+    dst[n + i] = src[i].g;
+    dst[2 * n + i] = src[i].b;
+  }
+}
+
+/**
+ * Unpack planar bytes into colors
+ *
+ * # Parameters
+ * - src: Input buffer of n * PLANAR_SIZE bytes
+ * - dst: Output colors
+ * - n: Number of colors
+ */
+void unpack_planar(const uint8_t *restrict src, struct color *restrict dst, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    dst[i] = (struct color) { src[i], src[n + i], src[2 * n + i] };
+  }
 }
 
 /**
- * Format a RGB color struct into a ratio color string
+ * Pack colors into fixed-width lower case hex, six digits per color without
+ * '#', separators or terminating null byte
  *
- * # Parameter:
- * - color: RGB color struct
- * - buffer: Address to a string buffer to write ratio color string
+ * # Parameters
+ * - src: Colors to pack
+ * - dst: Output buffer of at least n * HEX_SIZE bytes
+ * - n: Number of colors
  */
-void format_ratio(const struct color color, char *buffer) {
-  if (buffer == NULL) { return; }
+void pack_hex(const struct color *restrict src, char *restrict dst, size_t n) {
+  static const char digits[] = "0123456789abcdef";
+
+  for (size_t i = 0; i < n; i++) {
+    dst[6 * i + 0] = digits[src[i].r >> 4];
+    dst[6 * i + 1] = digits[src[i].r & 0xf];
+    dst[6 * i + 2] = digits[src[i].g >> 4];
+    dst[6 * i + 3] = digits[src[i].g & 0xf];
+    dst[6 * i + 4] = digits[src[i].b >> 4];
+    dst[6 * i + 5] = digits[src[i].b & 0xf];
+  }
+}
 
-  float rr = (double) color.r / 255.0;
-  float rg = (double) color.g / 255.0;
-  float rb = (double) color.b / 255.0;
+/**
+ * Unpack fixed-width hex into colors
+ *
+ * # Parameters
+ * - src: Input buffer of n * HEX_SIZE hex digits
+ * - dst: Output colors
+ * - n: Number of colors
+ *
+ * # Return
+ * 0 on success, 1 on failure
+ */
+int unpack_hex(const char *restrict src, struct color *restrict dst, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    uint8_t channels[3];
+    for (int c = 0; c < 3; c++) {
+      int hi = hex_digit(src[6 * i + 2 * c]);
+      int lo = hex_digit(src[6 * i + 2 * c + 1]);
+      if (hi < 0 || lo < 0) { return 1; }
+      channels[c] = (uint8_t) (hi << 4 | lo);
+    }
+    dst[i] = (struct color) { channels[0], channels[1], channels[2] };
+  }
 
-  (void)snprintf(buffer, 15, "%0.2f,%0.2f,%0.2f", rr, rg, rb);
+  return 0;
 }
@@ -10,6 +10,28 @@
  */
 #define MAX_ARGS 1024
 
+/*
+ * Number of colors converted at once when streaming raw colors
+ */
+#define STREAM_BLOCK 4096
+
+/*
+ * Formats colors can be streamed in or written out as
+ */
+enum stream_format {
+  FORMAT_TEXT,
+  FORMAT_RGB24,
+  FORMAT_RGBA32,
+  FORMAT_PLANAR,
+  FORMAT_HEX,
+};
+
+static enum stream_format input_format = FORMAT_TEXT;
+static enum stream_format output_format = FORMAT_TEXT;
+
+void parse_formats(int argc, char *argv[]);
+int parse_format(const char *value, enum stream_format *format);
+size_t format_size(enum stream_format format);
 void parse_args(int argc, char *argv[]);
 void print_help(void);
 int print_rgb(const char *rgb);
@@ -18,6 +40,9 @@ int print_hsl(const char *hsl);
 int print_percent(const char *percent);
 int print_ratio(const char *ratio);
 void print_color(const struct color color);
+void write_colors(const struct color *colors, size_t n);
+int flush_colors(void);
+int convert_stream(void);
 
 /**
  * Take command line argument for various color formats, process them, and print the colors in various representation
@@ -41,7 +66,103 @@ int main(int argc, char *argv[]) {
     }
   }
 
+  parse_formats(argc, argv);
   parse_args(argc, argv);
+
+  int status = EXIT_SUCCESS;
+  if (input_format != FORMAT_TEXT && convert_stream() != 0) {
+    status = EXIT_FAILURE;
+  }
+
+  if (flush_colors() != 0 || fflush(stdout) != 0 || ferror(stdout)) {
+    (void)fprintf(stderr, "Error with output: could not write stdout\n");
+    exit(EXIT_FAILURE);
+  }
+  exit(status);
+}
+
+/**
+ * Find the --input and --output arguments so that they apply to every color,
+ * wherever they are placed on the command line
+ *
+ * # Parameters
+ * - argc: Number of command line arguments
+ * - argv: Array of command line arguments
+ */
+void parse_formats(int argc, char *argv[]) {
+  for (int i = 1; i < argc; i++) {
+    bool input = strcmp(argv[i], "--input") == 0;
+    bool output = strcmp(argv[i], "--output") == 0;
+    if (!input && !output) { continue; }
+
+    if (++i >= argc) {
+      (void)fprintf(stderr, "%s requires a value.\n", argv[i - 1]);
+      exit(EXIT_FAILURE);
+    }
+
+    enum stream_format format;
+    if (parse_format(argv[i], &format) != 0) {
+      (void)fprintf(stderr, "Error with format: '%s'\n", argv[i]);
+      exit(EXIT_FAILURE);
+    }
+
+    if (input) {
+      if (format == FORMAT_TEXT) {
+        (void)fprintf(stderr, "--input does not accept the text format.\n");
+        exit(EXIT_FAILURE);
+      }
+      input_format = format;
+    } else {
+      output_format = format;
+    }
+  }
+}
+
+/**
+ * Parse the name of a stream format
+ *
+ * # Parameters
+ * - value: Name of the format
+ * - format: Address of the format
+ *
+ * # Return
+ * 0 on success, 1 on failure
+ */
+int parse_format(const char *value, enum stream_format *format) {
+  if (strcmp(value, "text") == 0) {
+    *format = FORMAT_TEXT;
+  } else if (strcmp(value, "rgb24") == 0) {
+    *format = FORMAT_RGB24;
+  } else if (strcmp(value, "rgba32") == 0) {
+    *format = FORMAT_RGBA32;
+  } else if (strcmp(value, "planar") == 0) {
+    *format = FORMAT_PLANAR;
+  } else if (strcmp(value, "hex") == 0) {
+    *format = FORMAT_HEX;
+  } else {
+    return 1;
+  }
+
+  return 0;
+}
+
+/**
+ * Size in bytes of a single color in a raw stream format
+ *
+ * # Parameters
+ * - format: Raw stream format
+ *
+ * # Return
+ * Number of bytes per color
+ */
+size_t format_size(enum stream_format format) {
+  switch (format) {
+    case FORMAT_RGB24: return RGB24_SIZE;
+    case FORMAT_RGBA32: return RGBA32_SIZE;
+    case FORMAT_PLANAR: return PLANAR_SIZE;
+    case FORMAT_HEX: return HEX_SIZE;
+    default: return 0;
+  }
 }
 
 /**
@@ -103,6 +224,8 @@ void parse_args(int argc, char *argv[]) {
         (void)fprintf(stderr, "--ratio requires a value.\n");
         exit(EXIT_FAILURE);
       }
+    } else if (strcmp(argv[i], "--input") == 0 || strcmp(argv[i], "--output") == 0) {
+      i++;
     } else {
       (void)fprintf(stderr, "error: '%s' did not match any arguments\n", argv[i]);
       exit(EXIT_FAILURE);
@@ -121,6 +244,8 @@ void print_help(void) {
   printf("--hsl      : Specify color in HSL format\n");
   printf("--percent  : Specify color in percentage format\n");
   printf("--ratio    : Specify color in ratio format\n");
+  printf("--input    : Read raw colors from stdin (rgb24, rgba32, planar, hex)\n");
+  printf("--output   : Write colors to stdout as (text, rgb24, rgba32, planar, hex)\n");
   printf("--help     : Print this help message\n");
   exit(EXIT_SUCCESS);
 }
@@ -137,7 +262,7 @@ void print_help(void) {
 int print_rgb(const char *rgb) {
   struct color color;
   if (parse_rgb(rgb, &color) != 0) { return 1; }
-  print_color(color);
+  write_colors(&color, 1);
   return 0;
 }
 
@@ -153,7 +278,7 @@ int print_rgb(const char *rgb) {
 int print_hex(const char *hex) {
   struct color color;
   if (parse_hex(hex, &color) != 0) { return 1; }
-  print_color(color);
+  write_colors(&color, 1);
   return 0;
 }
 
@@ -169,7 +294,7 @@ int print_hex(const char *hex) {
 int print_hsl(const char *hsl) {
   struct color color;
   if (parse_hsl(hsl, &color) != 0) { return 1; }
-  print_color(color);
+  write_colors(&color, 1);
   return 0;
 }
 
@@ -185,7 +310,7 @@ int print_hsl(const char *hsl) {
 int print_percent(const char *percent) {
   struct color color;
   if (parse_percent(percent, &color) != 0) { return 1; }
-  print_color(color);
+  write_colors(&color, 1);
   return 0;
 }
 
@@ -201,7 +326,7 @@ int print_percent(const char *percent) {
 int print_ratio(const char *ratio) {
   struct color color;
   if (parse_ratio(ratio, &color) != 0) { return 1; }
-  print_color(color);
+  write_colors(&color, 1);
   return 0;
 }
 
@@ -220,3 +345,135 @@ void print_color(const struct color color) {
   format_ratio(color, ratio);
   printf("rgb: %s ; hex: %s ; hsl: %s ; percent: %s ; ratio: %s\n", rgb, hex, hsl, percent, ratio);
 }
+
+/*
+ * Colors waiting to be written, they are written by whole blocks of
+ * STREAM_BLOCK colors so that planar output keeps its block layout
+ */
+static struct color pending[STREAM_BLOCK];
+static size_t pending_count = 0;
+
+/**
+ * Write colors to the stdout in the output format, raw colors are queued and
+ * every full block is written right away
+ *
+ * # Parameters:
+ * - colors: Colors to be written
+ * - n: Number of colors
+ */
+void write_colors(const struct color *colors, size_t n) {
+  if (output_format == FORMAT_TEXT) {
+    for (size_t i = 0; i < n; i++) { print_color(colors[i]); }
+    return;
+  }
+
+  while (n > 0) {
+    size_t count = STREAM_BLOCK - pending_count;
+    if (n < count) { count = n; }
+
+    memcpy(pending + pending_count, colors, count * sizeof(struct color));
+    pending_count += count;
+    if (pending_count == STREAM_BLOCK && flush_colors() != 0) {
+      (void)fprintf(stderr, "Error with output: could not write stdout\n");
+      exit(EXIT_FAILURE);
+    }
+
+    colors += count;
+    n -= count;
+  }
+}
+
+/**
+ * Write the queued colors to the stdout in the output format as a single
+ * block, the last block of a planar stream may be shorter than STREAM_BLOCK
+ *
+ * # Return
+ * 0 on success, 1 if the block could not be written
+ */
+int flush_colors(void) {
+  static uint8_t buffer[STREAM_BLOCK * HEX_SIZE];
+
+  if (pending_count == 0) { return 0; }
+
+  switch (output_format) {
+    case FORMAT_RGB24:
+      pack_rgb24(pending, buffer, pending_count);
+      break;
+    case FORMAT_RGBA32:
+      pack_rgba32(pending, buffer, pending_count);
+      break;
+    case FORMAT_PLANAR:
+      pack_planar(pending, buffer, pending_count);
+      break;
+    case FORMAT_HEX:
+      pack_hex(pending, (char *) buffer, pending_count);
+      break;
+    default:
+      return 1;
+  }
+
+  size_t written = fwrite(buffer, format_size(output_format), pending_count, stdout);
+  if (written != pending_count) { return 1; }
+
+  pending_count = 0;
+
+  return 0;
+}
+
+/**
+ * Read raw colors from the stdin in the input format and write them in the
+ * output format. Planar streams are split in blocks of STREAM_BLOCK colors,
+ * the last block holding the remaining colors, and a single newline at the end
+ * of a hex stream is ignored
+ *
+ * # Return
+ * 0 on success, 1 on failure
+ */
+int convert_stream(void) {
+  static uint8_t buffer[STREAM_BLOCK * HEX_SIZE];
+  static struct color colors[STREAM_BLOCK];
+  size_t size = format_size(input_format);
+
+  for (;;) {
+    size_t got = fread(buffer, 1, STREAM_BLOCK * size, stdin);
+    if (input_format == FORMAT_HEX && got < STREAM_BLOCK * size && got % size == 1 && buffer[got - 1] == '\n') {
+      got--;
+    }
+    if (got % size != 0) {
+      (void)fprintf(stderr, "Error with input: truncated color\n");
+      return 1;
+    }
+
+    size_t n = got / size;
+    switch (input_format) {
+      case FORMAT_RGB24:
+        unpack_rgb24(buffer, colors, n);
+        break;
+      case FORMAT_RGBA32:
+        unpack_rgba32(buffer, colors, n);
+        break;
+      case FORMAT_PLANAR:
+        unpack_planar(buffer, colors, n);
+        break;
+      case FORMAT_HEX:
+        if (unpack_hex((const char *) buffer, colors, n) != 0) {
+          (void)fprintf(stderr, "Error with input: invalid hex\n");
+          return 1;
+        }
+        break;
+      default:
+        return 1;
+    }
+
+    write_colors(colors, n);
+    if (ferror(stdout)) { return 1; }
+
+    if (got < STREAM_BLOCK * size) {
+      if (ferror(stdin)) {
+        (void)fprintf(stderr, "Error with input: could not read stdin\n");
+        return 1;
+      }
+      return 0;
+    }
+  }
+}
@@ -26,6 +26,10 @@ Test(color_convert, parse_rgb) {
   assert_color("parse_rgb", color, 60, 20, 10);
   cr_assert_eq(parse_rgb("60,180,60", &color), 0);
   assert_color("parse_rgb", color, 60, 180, 60);
+  cr_assert_eq(parse_rgb("255.0,0,0", &color), 1);
+  cr_assert_eq(parse_rgb("1e2,0,0", &color), 1);
+  cr_assert_eq(parse_rgb("0x10,0,0", &color), 1);
+  cr_assert_eq(parse_rgb("256,0,0", &color), 1);
 }
 
 Test(color_convert, parse_hex) {
@@ -124,6 +128,10 @@ Test(color_convert,  rgb_to_hsl) {
   cr_assert_str_eq(hsl, "12,71,13");
   format_hsl((const struct color) { 60, 180, 60 }, hsl);
   cr_assert_str_eq(hsl, "120,50,47");
+  format_hsl((const struct color) { 255, 0, 128 }, hsl);
+  cr_assert_str_eq(hsl, "329,100,50");
+  format_hsl((const struct color) { 61, 0, 1 }, hsl);
+  cr_assert_str_eq(hsl, "359,99,11");
 }
 
 Test(color_convert, rgb_to_percent) {
@@ -153,3 +161,194 @@ Test(color_convert, rgb_to_ratio) {
   format_ratio((const struct color) { 60,180,60 }, ratio);
   cr_assert_str_eq(ratio, "0.24,0.71,0.24");
 }
+
+void assert_color16(const char *id, struct color16 color, uint16_t r, uint16_t g, uint16_t b) {
+  cr_assert(r == color.r && g == color.g && b == color.b,
+            "%s: expected (%d, %d, %d) but got (%d, %d, %d)",
+            id, r, g, b, color.r, color.g, color.b);
+}
+
+void assert_colorf(const char *id, struct colorf color, float r, float g, float b) {
+  cr_assert(fabsf(r - color.r) < 1e-6 && fabsf(g - color.g) < 1e-6 && fabsf(b - color.b) < 1e-6,
+            "%s: expected (%f, %f, %f) but got (%f, %f, %f)",
+            id, r, g, b, color.r, color.g, color.b);
+}
+
+Test(color_convert16, parse) {
+  struct color16 color;
+  cr_assert_eq(parse_rgb16("0,49087,65535", &color), 0);
+  assert_color16("parse_rgb16", color, 0, 49087, 65535);
+  cr_assert_eq(parse_rgb16("65536,0,0", &color), 1);
+  cr_assert_eq(parse_rgb16("1.5,0,0", &color), 1);
+  cr_assert_eq(parse_hex16("#3c3cb4b43c3c", &color), 0);
+  assert_color16("parse_hex16", color, 15420, 46260, 15420);
+  cr_assert_eq(parse_hex16("#3cb43c", &color), 1);
+  cr_assert_eq(parse_hsl16("195,100,50", &color), 0);
+  assert_color16("parse_hsl16", color, 0, 49151, 65535);
+  cr_assert_eq(parse_percent16("0.0,74.9,100.0", &color), 0);
+  assert_color16("parse_percent16", color, 0, 49086, 65535);
+  cr_assert_eq(parse_ratio16("0.23529,0.07843,0.03922", &color), 0);
+  assert_color16("parse_ratio16", color, 15420, 5140, 2570);
+}
+
+Test(color_convert16, format) {
+  char buffer[MAX_STR_LEN];
+  format_rgb16((const struct color16) { 0, 49087, 65535 }, buffer);
+  cr_assert_str_eq(buffer, "0,49087,65535");
+  format_hex16((const struct color16) { 15420, 46260, 15420 }, buffer);
+  cr_assert_str_eq(buffer, "#3c3cb4b43c3c");
+  format_hsl16((const struct color16) { 15420, 5140, 2570 }, buffer);
+  cr_assert_str_eq(buffer, "12.0000,71.4286,13.7255");
+  format_percent16((const struct color16) { 0, 49087, 65535 }, buffer);
+  cr_assert_str_eq(buffer, "0.000,74.902,100.000");
+  format_ratio16((const struct color16) { 15420, 5140, 2570 }, buffer);
+  cr_assert_str_eq(buffer, "0.23529,0.07843,0.03922");
+}
+
+Test(color_convert16, ratio_roundtrip) {
+  char buffer[MAX_STR_LEN];
+  struct color16 color;
+  for (uint32_t v = 0; v <= 65535; v++) {
+    format_ratio16((const struct color16) { v, v, v }, buffer);
+    cr_assert_eq(parse_ratio16(buffer, &color), 0);
+    assert_color16("ratio16 round trip", color, v, v, v);
+  }
+}
+
+Test(color_convertf, parse) {
+  struct colorf color;
+  cr_assert_eq(parse_rgbf("127.5,63.75,31.875", &color), 0);
+  assert_colorf("parse_rgbf", color, 0.5, 0.25, 0.125);
+  cr_assert_eq(parse_rgbf("256,0,0", &color), 1);
+  cr_assert_eq(parse_hexf("#7fff3fff1fff", &color), 0);
+  assert_colorf("parse_hexf", color, 32767.0 / 65535.0, 16383.0 / 65535.0, 8191.0 / 65535.0);
+  cr_assert_eq(parse_hslf("195,100,50", &color), 0);
+  assert_colorf("parse_hslf", color, 0.0, 0.75, 1.0);
+  cr_assert_eq(parse_percentf("50,25,12.5", &color), 0);
+  assert_colorf("parse_percentf", color, 0.5, 0.25, 0.125);
+  cr_assert_eq(parse_ratiof("0.5,0.25,0.125", &color), 0);
+  assert_colorf("parse_ratiof", color, 0.5, 0.25, 0.125);
+}
+
+Test(color_convertf, format) {
+  char buffer[MAX_STR_LEN];
+  format_rgbf((const struct colorf) { 0.5, 0.25, 0.125 }, buffer);
+  cr_assert_str_eq(buffer, "127.500,63.750,31.875");
+  format_hexf((const struct colorf) { 1.0, 1.0, 1.0 }, buffer);
+  cr_assert_str_eq(buffer, "#ffffffffffff");
+  format_hexf((const struct colorf) { -0.1, 2.0, 0.5 }, buffer);
+  cr_assert_str_eq(buffer, "#0000ffff7fff");
+  format_hexf((const struct colorf) { NAN, 0.0, 1.0 }, buffer);
+  cr_assert_str_eq(buffer, "#00000000ffff");
+  format_hslf((const struct colorf) { 0.0, 0.75, 1.0 }, buffer);
+  cr_assert_str_eq(buffer, "195.0000,100.0000,50.0000");
+  format_percentf((const struct colorf) { 0.5, 0.25, 0.125 }, buffer);
+  cr_assert_str_eq(buffer, "50.0000,25.0000,12.5000");
+  format_ratiof((const struct colorf) { 0.5, 0.25, 0.125 }, buffer);
+  cr_assert_str_eq(buffer, "0.500000,0.250000,0.125000");
+}
+
+Test(color_depth, convert) {
+  struct color src[3] = { { 0, 191, 255 }, { 60, 20, 10 }, { 255, 255, 255 } };
+  struct color16 deep[3];
+  struct colorf flat[3];
+  struct color back[3];
+  convert_color_to_color16(src, deep, 3);
+  assert_color16("convert_color_to_color16", deep[0], 0, 49087, 65535);
+  assert_color16("convert_color_to_color16", deep[1], 15420, 5140, 2570);
+  convert_color16_to_colorf(deep, flat, 3);
+  assert_colorf("convert_color16_to_colorf", flat[2], 1.0, 1.0, 1.0);
+  convert_colorf_to_color(flat, back, 3);
+  for (int i = 0; i < 3; i++) {
+    assert_color("convert_colorf_to_color", back[i], src[i].r, src[i].g, src[i].b);
+  }
+  convert_color16_to_color((const struct color16[]) { { 65534, 128, 127 } }, back, 1);
+  assert_color("convert_color16_to_color", back[0], 255, 0, 0);
+}
+
+Test(color_depth, convert_blocks) {
+  struct color src[17];
+  struct color16 deep[17];
+  struct color back[17];
+  for (int i = 0; i < 17; i++) { src[i] = (struct color) { i, 127 + i, 255 - i }; }
+  convert_color_to_color16(src, deep, 17);
+  convert_color16_to_color(deep, back, 17);
+  for (int i = 0; i < 17; i++) {
+    assert_color16("convert_color_to_color16", deep[i], 257 * i, 257 * (127 + i), 257 * (255 - i));
+    assert_color("convert_color16_to_color", back[i], src[i].r, src[i].g, src[i].b);
+  }
+}
+
+Test(color_batch, parse) {
+  const char *values[3] = { "#00bfff", "#3c140a", "#3cb43c" };
+  struct color colors[3];
+  cr_assert_eq(parse_hex_batch(values, colors, 3), 0);
+  assert_color("parse_hex_batch", colors[0], 0, 191, 255);
+  assert_color("parse_hex_batch", colors[1], 60, 20, 10);
+  assert_color("parse_hex_batch", colors[2], 60, 180, 60);
+  const char *invalid[2] = { "0,0,0", "256,0,0" };
+  cr_assert_eq(parse_rgb_batch(invalid, colors, 2), 1);
+}
+
+Test(color_batch, format) {
+  const struct color16 colors[2] = { { 0, 49087, 65535 }, { 15420, 5140, 2570 } };
+  char buffers[2][MAX_STR_LEN];
+  format_rgb16_batch(colors, buffers, 2);
+  cr_assert_str_eq(buffers[0], "0,49087,65535");
+  cr_assert_str_eq(buffers[1], "15420,5140,2570");
+  format_ratio16_batch(colors, buffers, 2);
+  cr_assert_str_eq(buffers[1], "0.23529,0.07843,0.03922");
+}
+
+Test(color_raw, rgb24) {
+  const struct color colors[2] = { { 0, 191, 255 }, { 60, 180, 60 } };
+  struct color back[2];
+  uint8_t buffer[2 * RGB24_SIZE];
+  pack_rgb24(colors, buffer, 2);
+  cr_assert(memcmp(buffer, "\x00\xbf\xff\x3c\xb4\x3c", sizeof(buffer)) == 0);
+  unpack_rgb24(buffer, back, 2);
+  assert_color("unpack_rgb24", back[0], 0, 191, 255);
+  assert_color("unpack_rgb24", back[1], 60, 180, 60);
+}
+
+Test(color_raw, rgba32) {
+  const struct color colors[2] = { { 0, 191, 255 }, { 60, 180, 60 } };
+  struct color back[2];
+  uint8_t buffer[2 * RGBA32_SIZE];
+  pack_rgba32(colors, buffer, 2);
+  cr_assert(memcmp(buffer, "\x00\xbf\xff\xff\x3c\xb4\x3c\xff", sizeof(buffer)) == 0);
+  unpack_rgba32(buffer, back, 2);
+  assert_color("unpack_rgba32", back[0], 0, 191, 255);
+  assert_color("unpack_rgba32", back[1], 60, 180, 60);
+  unpack_rgba32((const uint8_t *) "\x01\x02\x03\x00\x04\x05\x06\x80", back, 2);
+  assert_color("unpack_rgba32", back[0], 1, 2, 3);
+  assert_color("unpack_rgba32", back[1], 4, 5, 6);
+}
+
+Test(color_raw, planar) {
+  const struct color colors[3] = { { 1, 2, 3 }, { 4, 5, 6 }, { 7, 8, 9 } };
+  struct color back[3];
+  uint8_t buffer[3 * PLANAR_SIZE];
+  pack_planar(colors, buffer, 3);
+  cr_assert(memcmp(buffer, "\x01\x04\x07\x02\x05\x08\x03\x06\x09", sizeof(buffer)) == 0);
+  unpack_planar(buffer, back, 3);
+  assert_color("unpack_planar", back[0], 1, 2, 3);
+  assert_color("unpack_planar", back[1], 4, 5, 6);
+  assert_color("unpack_planar", back[2], 7, 8, 9);
+}
+
+Test(color_raw, hex) {
+  const struct color colors[2] = { { 0, 191, 255 }, { 171, 205, 239 } };
+  struct color back[2];
+  char buffer[2 * HEX_SIZE];
+  pack_hex(colors, buffer, 2);
+  cr_assert(memcmp(buffer, "00bfffabcdef", sizeof(buffer)) == 0);
+  cr_assert_eq(unpack_hex("00BFFFabcdef", back, 2), 0);
+  assert_color("unpack_hex", back[0], 0, 191, 255);
+  assert_color("unpack_hex", back[1], 171, 205, 239);
+  cr_assert_eq(unpack_hex("ABCDEF", back, 1), 0);
+  assert_color("unpack_hex", back[0], 171, 205, 239);
+  cr_assert_eq(unpack_hex("00bfff3cb4 c", back, 2), 1);
+  cr_assert_eq(unpack_hex("00bfgf", back, 1), 1);
+  cr_assert_eq(unpack_hex("#00bff", back, 1), 1);
+}
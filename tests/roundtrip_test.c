@@ -0,0 +1,429 @@
+#include <criterion/criterion.h>
+#include <criterion/logging.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "color.h"
+
+/*
+ * Number of 8-bit colors
+ */
+#define COLOR_COUNT (1u << 24)
+
+/*
+ * Number of colors handed to a round trip kernel at once
+ */
+#define CHUNK 4096
+
+/*
+ * Colors swept by a round trip. Every 8-bit kernel is swept over all colors.
+ * Higher depths have too many colors, their kernels sweep every value of every
+ * channel, and HSL, which mixes the channels, a sample of SAMPLE_COUNT colors
+ * scattered across the whole cube
+ */
+enum sweep {
+  SWEEP_CHANNELS,
+  SWEEP_SAMPLE,
+  SWEEP_ALL,
+};
+
+#define SAMPLE_COUNT (1u << 20)
+
+/*
+ * Round trip kernel, converts n colors of src through a format and back and
+ * sets error[i] to the largest channel error of src[i] in 8-bit steps, or to a
+ * negative value when src[i] could not be converted back
+ */
+typedef void (*roundtrip_kernel)(const struct color *src, double *error, size_t n);
+
+/*
+ * Result of a round trip over a range of colors
+ */
+struct roundtrip_stats {
+  uint64_t failures;
+  uint64_t mismatches;
+  double error_sum;
+  double max_error;
+  struct color worst;
+};
+
+/*
+ * Work of a single thread, it sweeps the colors in [start, end)
+ */
+struct roundtrip_job {
+  roundtrip_kernel kernel;
+  enum sweep sweep;
+  uint32_t start;
+  uint32_t end;
+  struct roundtrip_stats stats;
+};
+
+/**
+ * Sweep the colors of a job through its kernel and gather the stats of the
+ * thread
+ *
+ * # Parameters
+ * - arg: Address of the job
+ *
+ * # Return
+ * NULL
+ */
+static void *roundtrip_worker(void *arg) {
+  struct roundtrip_job *job = arg;
+  struct roundtrip_stats stats = { 0 };
+  struct color src[CHUNK];
+  double error[CHUNK];
+
+  for (uint32_t base = job->start; base < job->end; base += CHUNK) {
+    size_t n = job->end - base < CHUNK ? job->end - base : CHUNK;
+    for (size_t i = 0; i < n; i++) {
+      uint32_t v = base + (uint32_t) i;
+      if (job->sweep == SWEEP_SAMPLE) { v = (v * 2654435761u) & (COLOR_COUNT - 1); }
+      if (job->sweep != SWEEP_CHANNELS) {
+        src[i] = (struct color) { (uint8_t) (v >> 16), (uint8_t) (v >> 8), (uint8_t) v };
+      } else {
+        src[i] = (struct color) { (uint8_t) v, (uint8_t) (v + 85), (uint8_t) (v + 170) };
+      }
+    }
+
+    job->kernel(src, error, n);
+
+    for (size_t i = 0; i < n; i++) {
+      if (error[i] < 0.0) {
+        stats.failures++;
+        continue;
+      }
+      if (error[i] == 0.0) { continue; }
+
+      stats.mismatches++;
+      stats.error_sum += error[i];
+      if (error[i] > stats.max_error) {
+        stats.max_error = error[i];
+        stats.worst = src[i];
+      }
+    }
+  }
+
+  job->stats = stats;
+  return NULL;
+}
+
+/**
+ * Sweep 8-bit colors through a round trip kernel, spread across all cores
+ *
+ * # Parameters
+ * - name: Name of the round trip, used in the report
+ * - kernel: Round trip kernel
+ * - sweep: SWEEP_ALL for every color, SWEEP_SAMPLE for a sample of colors,
+ *   SWEEP_CHANNELS for every value of every channel
+ *
+ * # Return
+ * Stats merged from every thread
+ */
+static struct roundtrip_stats roundtrip(const char *name, roundtrip_kernel kernel, enum sweep sweep) {
+  uint32_t count = sweep == SWEEP_ALL ? COLOR_COUNT : sweep == SWEEP_SAMPLE ? SAMPLE_COUNT : 256;
+  long cores = sysconf(_SC_NPROCESSORS_ONLN);
+  size_t chunks = (count + CHUNK - 1) / CHUNK;
+  size_t threads = cores < 1 ? 1 : (size_t) cores;
+  if (threads > chunks) { threads = chunks; }
+  if (threads > 256) { threads = 256; }
+  pthread_t tids[256];
+  struct roundtrip_job jobs[256];
+
+  uint32_t step = count / threads;
+  for (size_t t = 0; t < threads; t++) {
+    jobs[t] = (struct roundtrip_job) {
+      .kernel = kernel,
+      .sweep = sweep,
+      .start = (uint32_t) t * step,
+      .end = t + 1 == threads ? count : (uint32_t) (t + 1) * step,
+    };
+    cr_assert_eq(pthread_create(&tids[t], NULL, roundtrip_worker, &jobs[t]), 0);
+  }
+
+  struct roundtrip_stats stats = { 0 };
+  for (size_t t = 0; t < threads; t++) {
+    pthread_join(tids[t], NULL);
+    stats.failures += jobs[t].stats.failures;
+    stats.mismatches += jobs[t].stats.mismatches;
+    stats.error_sum += jobs[t].stats.error_sum;
+    if (jobs[t].stats.max_error > stats.max_error) {
+      stats.max_error = jobs[t].stats.max_error;
+      stats.worst = jobs[t].stats.worst;
+    }
+  }
+
+  cr_log_info("%s: %llu failures, %llu mismatches, max error %.4f at (%d, %d, %d), mean error %.4f",
+              name,
+              (unsigned long long) stats.failures,
+              (unsigned long long) stats.mismatches,
+              stats.max_error, stats.worst.r, stats.worst.g, stats.worst.b,
+              stats.error_sum / count);
+
+  return stats;
+}
+
+/**
+ * Check the stats of a round trip against its allowed precision loss
+ *
+ * # Parameters
+ * - name: Name of the round trip
+ * - stats: Stats of the round trip
+ * - max_error: Largest channel error allowed in 8-bit steps, 0 for a lossless
+ *   round trip
+ */
+static void assert_roundtrip(const char *name, struct roundtrip_stats stats, double max_error) {
+  cr_assert_eq(stats.failures, 0, "%s: %llu colors failed to convert back",
+               name, (unsigned long long) stats.failures);
+  cr_assert(stats.max_error <= max_error,
+            "%s: error %f at (%d, %d, %d) exceeds %f",
+            name, stats.max_error, stats.worst.r, stats.worst.g, stats.worst.b, max_error);
+}
+
+/*
+ * Largest channel error between two colors of each depth, in 8-bit steps
+ */
+static double color_error(struct color a, struct color b) {
+  return fmax(abs(a.r - b.r), fmax(abs(a.g - b.g), abs(a.b - b.b)));
+}
+
+static double color16_error(struct color16 a, struct color16 b) {
+  return fmax(abs(a.r - b.r), fmax(abs(a.g - b.g), abs(a.b - b.b))) * 255.0 / 65535.0;
+}
+
+static double colorf_error(struct colorf a, struct colorf b) {
+  return fmax(fabsf(a.r - b.r), fmax(fabsf(a.g - b.g), fabsf(a.b - b.b))) * 255.0;
+}
+
+/*
+ * Every 16-bit value of a channel is reached from an 8-bit value, its high
+ * byte, and a step, its low byte. Float samples are those 16-bit values
+ */
+static struct color16 color16_sample(struct color color, uint32_t step) {
+  return (struct color16) {
+    (uint16_t) (color.r << 8 | step),
+    (uint16_t) (color.g << 8 | step),
+    (uint16_t) (color.b << 8 | step),
+  };
+}
+
+static struct colorf colorf_sample(struct color color, uint32_t step) {
+  struct color16 sample = color16_sample(color, step);
+  struct colorf result;
+  convert_color16_to_colorf(&sample, &result, 1);
+  return result;
+}
+
+#define ROUNDTRIP_TEXT(fmt) \
+  static void kernel_##fmt(const struct color *src, double *error, size_t n) { \
+    char buffer[MAX_STR_LEN]; \
+    for (size_t i = 0; i < n; i++) { \
+      struct color back; \
+      format_##fmt(src[i], buffer); \
+      error[i] = parse_##fmt(buffer, &back) != 0 ? -1.0 : color_error(src[i], back); \
+    } \
+  }
+
+ROUNDTRIP_TEXT(rgb)
+ROUNDTRIP_TEXT(hex)
+ROUNDTRIP_TEXT(hsl)
+ROUNDTRIP_TEXT(percent)
+ROUNDTRIP_TEXT(ratio)
+
+/*
+ * Round trips of the formats of a higher depth. Channel formats sweep every
+ * 16-bit value of a channel, HSL sweeps 8-bit colors converted to the depth
+ */
+#define ROUNDTRIP_DEPTH_TEXT(depth, sfx, fmt) \
+  static void kernel_##fmt##sfx(const struct color *src, double *error, size_t n) { \
+    char buffer[MAX_STR_LEN]; \
+    for (size_t i = 0; i < n; i++) { \
+      error[i] = 0.0; \
+      for (uint32_t step = 0; step < 256; step++) { \
+        struct depth sample = depth##_sample(src[i], step), back; \
+        format_##fmt##sfx(sample, buffer); \
+        if (parse_##fmt##sfx(buffer, &back) != 0) { \
+          error[i] = -1.0; \
+          break; \
+        } \
+        error[i] = fmax(error[i], depth##_error(sample, back)); \
+      } \
+    } \
+  }
+
+#define ROUNDTRIP_DEPTH_HSL(depth, sfx) \
+  static void kernel_hsl##sfx(const struct color *src, double *error, size_t n) { \
+    char buffer[MAX_STR_LEN]; \
+    struct depth samples[CHUNK]; \
+    convert_color_to_##depth(src, samples, n); \
+    for (size_t i = 0; i < n; i++) { \
+      struct depth back; \
+      format_hsl##sfx(samples[i], buffer); \
+      error[i] = parse_hsl##sfx(buffer, &back) != 0 ? -1.0 : depth##_error(samples[i], back); \
+    } \
+  }
+
+ROUNDTRIP_DEPTH_TEXT(color16, 16, rgb)
+ROUNDTRIP_DEPTH_TEXT(color16, 16, hex)
+ROUNDTRIP_DEPTH_HSL(color16, 16)
+ROUNDTRIP_DEPTH_TEXT(color16, 16, percent)
+ROUNDTRIP_DEPTH_TEXT(color16, 16, ratio)
+
+ROUNDTRIP_DEPTH_TEXT(colorf, f, rgb)
+ROUNDTRIP_DEPTH_TEXT(colorf, f, hex)
+ROUNDTRIP_DEPTH_HSL(colorf, f)
+ROUNDTRIP_DEPTH_TEXT(colorf, f, percent)
+ROUNDTRIP_DEPTH_TEXT(colorf, f, ratio)
+
+#define ROUNDTRIP_RAW(fmt, size) \
+  static void kernel_##fmt(const struct color *src, double *error, size_t n) { \
+    uint8_t buffer[CHUNK * size]; \
+    struct color back[CHUNK]; \
+    pack_##fmt(src, buffer, n); \
+    unpack_##fmt(buffer, back, n); \
+    for (size_t i = 0; i < n; i++) { error[i] = color_error(src[i], back[i]); } \
+  }
+
+ROUNDTRIP_RAW(rgb24, RGB24_SIZE)
+ROUNDTRIP_RAW(rgba32, RGBA32_SIZE)
+ROUNDTRIP_RAW(planar, PLANAR_SIZE)
+
+/*
+ * pack_hex checked against the reference parse_hex
+ */
+static void kernel_pack_hex(const struct color *src, double *error, size_t n) {
+  char buffer[CHUNK * HEX_SIZE];
+  pack_hex(src, buffer, n);
+  for (size_t i = 0; i < n; i++) {
+    char value[HEX_SIZE + 1];
+    struct color back;
+    memcpy(value, buffer + i * HEX_SIZE, HEX_SIZE);
+    value[HEX_SIZE] = '\0';
+    error[i] = parse_hex(value, &back) != 0 ? -1.0 : color_error(src[i], back);
+  }
+}
+
+/*
+ * unpack_hex checked against the reference format_hex
+ */
+static void kernel_unpack_hex(const struct color *src, double *error, size_t n) {
+  char buffer[CHUNK * HEX_SIZE] = { 0 };
+  struct color back[CHUNK];
+  for (size_t i = 0; i < n; i++) {
+    char value[MAX_STR_LEN];
+    format_hex(src[i], value);
+    memcpy(buffer + i * HEX_SIZE, value + 1, HEX_SIZE);
+  }
+  int failed = unpack_hex(buffer, back, n) != 0;
+  for (size_t i = 0; i < n; i++) {
+    error[i] = failed ? -1.0 : color_error(src[i], back[i]);
+  }
+}
+
+#define ROUNDTRIP_DEPTH(depth) \
+  static void kernel_##depth(const struct color *src, double *error, size_t n) { \
+    struct depth samples[CHUNK]; \
+    struct color back[CHUNK]; \
+    convert_color_to_##depth(src, samples, n); \
+    convert_##depth##_to_color(samples, back, n); \
+    for (size_t i = 0; i < n; i++) { error[i] = color_error(src[i], back[i]); } \
+  }
+
+ROUNDTRIP_DEPTH(color16)
+ROUNDTRIP_DEPTH(colorf)
+
+Test(roundtrip, rgb) {
+  assert_roundtrip("rgb", roundtrip("rgb", kernel_rgb, SWEEP_ALL), 0);
+}
+
+Test(roundtrip, hex) {
+  assert_roundtrip("hex", roundtrip("hex", kernel_hex, SWEEP_ALL), 0);
+}
+
+/*
+ * HSL and percentage strings are truncated to integers and ratio strings to two
+ * decimals, the bounds below are the precision lost by the current formats
+ */
+Test(roundtrip, hsl) {
+  assert_roundtrip("hsl", roundtrip("hsl", kernel_hsl, SWEEP_ALL), 10);
+}
+
+Test(roundtrip, percent) {
+  assert_roundtrip("percent", roundtrip("percent", kernel_percent, SWEEP_ALL), 3);
+}
+
+Test(roundtrip, ratio) {
+  assert_roundtrip("ratio", roundtrip("ratio", kernel_ratio, SWEEP_ALL), 2);
+}
+
+/*
+ * Bounds of the higher depths are in 8-bit steps. Every string of 16-bit
+ * colors carries enough decimals to be exact. HEX strings of float colors are
+ * quantized to 16 bits, and every other string is rounded to its decimals
+ */
+Test(roundtrip, rgb16) {
+  assert_roundtrip("rgb16", roundtrip("rgb16", kernel_rgb16, SWEEP_CHANNELS), 0);
+}
+
+Test(roundtrip, hex16) {
+  assert_roundtrip("hex16", roundtrip("hex16", kernel_hex16, SWEEP_CHANNELS), 0);
+}
+
+Test(roundtrip, hsl16) {
+  assert_roundtrip("hsl16", roundtrip("hsl16", kernel_hsl16, SWEEP_SAMPLE), 0);
+}
+
+Test(roundtrip, percent16) {
+  assert_roundtrip("percent16", roundtrip("percent16", kernel_percent16, SWEEP_CHANNELS), 0);
+}
+
+Test(roundtrip, ratio16) {
+  assert_roundtrip("ratio16", roundtrip("ratio16", kernel_ratio16, SWEEP_CHANNELS), 0);
+}
+
+Test(roundtrip, rgbf) {
+  assert_roundtrip("rgbf", roundtrip("rgbf", kernel_rgbf, SWEEP_CHANNELS), 0.001);
+}
+
+Test(roundtrip, hexf) {
+  assert_roundtrip("hexf", roundtrip("hexf", kernel_hexf, SWEEP_CHANNELS), 0.004);
+}
+
+Test(roundtrip, hslf) {
+  assert_roundtrip("hslf", roundtrip("hslf", kernel_hslf, SWEEP_SAMPLE), 0.001);
+}
+
+Test(roundtrip, percentf) {
+  assert_roundtrip("percentf", roundtrip("percentf", kernel_percentf, SWEEP_CHANNELS), 0.0003);
+}
+
+Test(roundtrip, ratiof) {
+  assert_roundtrip("ratiof", roundtrip("ratiof", kernel_ratiof, SWEEP_CHANNELS), 0.0003);
+}
+
+Test(roundtrip, rgb24) {
+  assert_roundtrip("rgb24", roundtrip("rgb24", kernel_rgb24, SWEEP_ALL), 0);
+}
+
+Test(roundtrip, rgba32) {
+  assert_roundtrip("rgba32", roundtrip("rgba32", kernel_rgba32, SWEEP_ALL), 0);
+}
+
+Test(roundtrip, planar) {
+  assert_roundtrip("planar", roundtrip("planar", kernel_planar, SWEEP_ALL), 0);
+}
+
+Test(roundtrip, pack_hex) {
+  assert_roundtrip("pack_hex", roundtrip("pack_hex", kernel_pack_hex, SWEEP_ALL), 0);
+}
+
+Test(roundtrip, unpack_hex) {
+  assert_roundtrip("unpack_hex", roundtrip("unpack_hex", kernel_unpack_hex, SWEEP_ALL), 0);
+}
+
+Test(roundtrip, color16) {
+  assert_roundtrip("color16", roundtrip("color16", kernel_color16, SWEEP_ALL), 0);
+}
+
+Test(roundtrip, colorf) {
+  assert_roundtrip("colorf", roundtrip("colorf", kernel_colorf, SWEEP_ALL), 0);
+}